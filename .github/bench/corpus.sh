@@ -0,0 +1,44 @@
+#!/bin/bash
+# Generates a corpus shaped like this repo for timing the keyword gate:
+# mostly small append-only text files like 1.txt or t.txt, one long
+# Markdown change log like README.md in every hundred files, and one file
+# in every HIT_EVERY (default 1000) containing a keyword from the list.
+# The output is deterministic for a given file count.
+#
+# Usage: corpus.sh <dir> <files>
+
+set -e
+dir=$1
+count=$2
+hit_every=${HIT_EVERY:-1000}
+here=$(cd "$(dirname "$0")/.." && pwd)
+
+# At most 1000 files per directory.
+dirs=$(( (count + 999) / 1000 ))
+width=${#dirs}
+mkdir -p "$dir/.github"
+cp "$here/keywords.txt" "$here/keyword-hits.awk" "$dir/.github/"
+seq -f "$dir/d%0${width}g" 0 $(( dirs - 1 )) | xargs mkdir -p
+git -C "$dir" init -q
+
+awk -v dir="$dir" -v count="$count" -v dirs="$dirs" -v width="$width" \
+	-v hit_every="$hit_every" '
+	$0 != "" { keywords[nkeywords++] = $0 }
+	END {
+		for (i = 0; i < count; i++) {
+			sub_dir = sprintf("%s/d%0" width "d", dir, i % dirs)
+			if (i % 100 == 0) {
+				path = sprintf("%s/log%d.md", sub_dir, i)
+				print "# Change log" > path
+				for (n = 1; n <= 400; n++)
+					printf "# Author%d Branch%d change%d\n", n % 7, n % 53, n > path
+			} else {
+				path = sprintf("%s/%d.txt", sub_dir, i)
+				for (n = 0; n <= i % 10; n++)
+					printf "# branch%d change%d\n\n", i % 101, n > path
+			}
+			if (i % hit_every == hit_every - 1)
+				printf "note on %s in branch%d\n", keywords[i % nkeywords], i > path
+			close(path)
+		}
+	}' "$here/keywords.txt"
@@ -0,0 +1,73 @@
+#!/bin/bash
+# Times the keyword gate on generated corpora (see corpus.sh) and prints
+# one JSON object per corpus size and thread count. BENCH_JOBS lists the
+# KEYWORD_SCAN_JOBS values to sweep (default: 1, 2, 4, ... up to the
+# number of cores). grep_ms is a plain recursive GNU grep
+# over the same files, as a reference for the matcher's own cost.
+# Latency percentiles are per grep batch, as reported by the gate's
+# statistics. peak_rss_kb is the largest resident size of any process in
+# the gate, from GNU time; it is null when /usr/bin/time is missing.
+#
+# Usage: run.sh [files...]    (default: 1000 10000 100000)
+
+set -e
+here=$(cd "$(dirname "$0")/.." && pwd)
+[ $# -gt 0 ] || set -- 1000 10000 100000
+if [ -z "$BENCH_JOBS" ]
+then
+	cores=$(nproc)
+	for (( n = 1; n < cores; n *= 2 ))
+	do
+		BENCH_JOBS="$BENCH_JOBS $n"
+	done
+	BENCH_JOBS="$BENCH_JOBS $cores"
+fi
+
+for count in "$@"
+do
+	corpus=$(mktemp -d)
+	"$here/bench/corpus.sh" "$corpus" "$count"
+
+	started=$(date +%s%N)
+	(cd "$corpus" && LC_ALL=C grep -r -F -f .github/keywords.txt --exclude-dir=.git --exclude=keywords.txt . > /dev/null) || true
+	grep_ms=$(( ($(date +%s%N) - started) / 1000000 ))
+
+	for jobs in $BENCH_JOBS
+	do
+		timer=()
+		if [ -x /usr/bin/time ]
+		then
+			timer=(/usr/bin/time -f %M -o "$corpus.rss")
+		fi
+		started=$(date +%s%N)
+		(cd "$corpus" && KEYWORD_SCAN_HIDDEN=true KEYWORD_SCAN_STATS=true KEYWORD_SCAN_JOBS="$jobs" \
+			"${timer[@]}" bash "$here/keyword-check.sh" > /dev/null 2> "$corpus.stats") || true
+		gate_ms=$(( ($(date +%s%N) - started) / 1000000 ))
+		peak_rss_kb=null
+		if [ -s "$corpus.rss" ]
+		then
+			peak_rss_kb=$(tail -n 1 "$corpus.rss")
+		fi
+
+		awk -v count="$count" -v jobs="$jobs" -v gate_ms="$gate_ms" -v grep_ms="$grep_ms" \
+			-v peak_rss_kb="$peak_rss_kb" '
+			/^\{"mode"/ {
+				gsub(/[{}",:]/, " ")
+				for (i = 1; i < NF; i++)
+					stats[$i] = $(i + 1)
+			}
+			END {
+				if (!("selected_bytes" in stats)) {
+					print "bench: no statistics from the gate" > "/dev/stderr"
+					exit 1
+				}
+				seconds = (gate_ms > 0 ? gate_ms : 1) / 1000
+				printf "{\"files\": %d, \"jobs\": %d, \"bytes\": %d, \"gate_ms\": %d, \"scan_ms\": %d, \"grep_ms\": %d, \"files_per_s\": %d, \"mb_per_s\": %.1f, \"batch_p50_ms\": %s, \"batch_p99_ms\": %s, \"peak_rss_kb\": %s}\n",
+					count, jobs, stats["selected_bytes"], gate_ms, stats["scan_ms"], grep_ms,
+					count / seconds, stats["selected_bytes"] / seconds / 1e6,
+					stats["batch_p50_ms"], stats["batch_p99_ms"], peak_rss_kb
+			}' "$corpus.stats"
+		rm -f "$corpus.stats" "$corpus.rss"
+	done
+	rm -rf "$corpus"
+done
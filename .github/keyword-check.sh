@@ -0,0 +1,205 @@
+#!/bin/bash
+# Keyword gate run by the build workflow; the KEYWORD_SCAN_* options are
+# described where the workflow sets them. Run from the top of the tree.
+started=$(date +%s%N)
+# Results are only reusable for the same keyword list and match options.
+key=$({ cat .github/keywords.txt; echo "$KEYWORD_SCAN_HIDDEN $KEYWORD_SCAN_ICASE $KEYWORD_SCAN_WORD"; } |
+	git hash-object --stdin)
+base=$(git rev-parse -q --verify "$KEYWORD_SCAN_BASE^{commit}")
+keywords="$PWD/.github/keywords.txt"
+jobs=${KEYWORD_SCAN_JOBS:-$(nproc)}
+scratch="$(mktemp -d)"
+trap 'rm -rf "$scratch"' EXIT
+set -- . ':!.github/keywords.txt'
+if [ "$KEYWORD_SCAN_HIDDEN" != "true" ]
+then
+	set -- "$@" ':!.*' ':!**/.*'
+fi
+# Files to scan, NUL-separated and relative to $root. Untracked files
+# are included unless .gitignore excludes them, so build output listed
+# there is never read.
+files="$scratch/files"
+# Working-tree candidates: `ls-files -s` entries for tracked files, and
+# plain paths for untracked ones.
+stage="$scratch/stage"
+untracked="$scratch/untracked"
+# Symlinks are scanned as their link text, the way git stores them, from
+# copies written below this directory; they are never followed.
+links="$scratch/links"
+root=.
+objects=0
+mode=worktree
+skipped=0
+if [ -n "$KEYWORD_SCAN_REFS" ]
+then
+	# Stage every distinct blob reachable from the refs once, in a scratch
+	# index under "<path>/<blob oid>", and write them out below the scratch
+	# directory: nothing is checked out over the working tree, and content
+	# shared between branches is inflated and scanned only once.
+	export GIT_INDEX_FILE="$scratch/index"
+	read -r -a refs <<< "$KEYWORD_SCAN_REFS"
+	git for-each-ref --format='%(objectname)^{tree}' "${refs[@]}" |
+		git cat-file --batch-check='%(objectname)' |
+		grep -v ' missing$' |
+		sort -u |
+		while read -r tree
+		do
+			git ls-tree -r "$tree"
+		done |
+		awk -F '\t' '
+			split($1, entry, " ") && entry[2] == "blob" && !seen[entry[3]]++ {
+				path = $2
+				if (path ~ /^"/)
+					path = substr(path, 1, length(path) - 1) "/" entry[3] "\""
+				else
+					path = path "/" entry[3]
+				print $1 "\t" path
+			}' |
+		git update-index --add --index-info
+	git ls-files -z -- "$@" > "$files"
+	# A mistyped pattern must not turn into an empty, passing scan.
+	if [ ! -s "$files" ]
+	then
+		echo "Keyword check error: no blobs found for KEYWORD_SCAN_REFS=$KEYWORD_SCAN_REFS" >&2
+		exit 2
+	fi
+	root="$scratch/tree"
+	# With core.symlinks off, link blobs are written as plain files holding
+	# the link text, so they are scanned as such and can never dangle.
+	if ! git -c core.symlinks=false -c checkout.workers="$jobs" \
+		checkout-index -z --stdin --prefix="$root/" < "$files"
+	then
+		echo "Keyword check error: could not write out blobs for KEYWORD_SCAN_REFS=$KEYWORD_SCAN_REFS" >&2
+		exit 2
+	fi
+	objects=1
+	mode=objects
+elif [ -n "$KEYWORD_SCAN_CACHE" ] && [ -n "$base" ] && [ -e "$KEYWORD_SCAN_CACHE/$key/$base" ]
+then
+	# The base passed this exact check, so only files that differ from it
+	# can introduce hits.
+	git diff -z --name-only --diff-filter=d "$base" -- "$@" |
+		xargs -0 -r git --literal-pathspecs ls-files -z -s -- > "$stage"
+	if [ "$KEYWORD_SCAN_STATS" = "true" ]
+	then
+		# Only tracked files can be skipped; untracked ones are always scanned.
+		skipped=$(( $(git ls-files -- "$@" | wc -l) - $(tr -cd '\0' < "$stage" | wc -c) ))
+	fi
+	git ls-files -z --others --exclude-standard -- "$@" > "$untracked"
+	mode=incremental
+else
+	git ls-files -z -s -- "$@" > "$stage"
+	git ls-files -z --others --exclude-standard -- "$@" > "$untracked"
+fi
+if [ "$objects" -eq 0 ]
+then
+	# Tracked: regular files (100644, 100755) are scanned in place and
+	# symlinks (120000) via their link text; gitlinks are skipped.
+	sed -z -n -E 's/^100(644|755) [^\t]*\t//p' "$stage" > "$files"
+	xargs -0 -r sh -c '
+		for f
+		do
+			if [ -f "$f" ] && [ ! -L "$f" ]
+			then
+				printf "%s\0" "$f"
+			fi
+		done' sh < "$untracked" >> "$files"
+	{
+		sed -z -n 's/^120000 [^\t]*\t//p' "$stage"
+		cat "$untracked"
+	} |
+		xargs -0 -r sh -c '
+			for f
+			do
+				if [ -L "$f" ]
+				then
+					mkdir -p "$0/$(dirname "$f")"
+					printf "%s" "$(readlink -- "$f")" > "$0/$f"
+					printf "%s\0" "$0/$f"
+				fi
+			done' "$links" >> "$files"
+fi
+match=(-F)
+icase=0
+word=0
+if [ "$KEYWORD_SCAN_ICASE" = "true" ]
+then
+	match+=(-i)
+	icase=1
+fi
+if [ "$KEYWORD_SCAN_WORD" = "true" ]
+then
+	match+=(-w)
+	word=1
+fi
+selected=$(date +%s%N)
+# git only lists the files; GNU grep matches them, building one
+# fixed-string automaton per process and making a single pass over each
+# file. $jobs batches run at a time; each batch's output is copied out
+# under a lock so records from different batches never interleave.
+# -I drops binary files (NUL in the first buffer) without scanning them.
+# With statistics on, each batch's grep time is appended to out.batches.
+# One JSON object per hit on stdout: file, line, column, keyword, blob_oid.
+(cd "$root" &&
+	LC_ALL=C xargs -0 -r -n 256 -P "$jobs" sh -c '
+		[ "$KEYWORD_SCAN_STATS" = "true" ] && started=$(date +%s%N)
+		grep -H -n -Z -I "$@" > "$0.$$"
+		status=$?
+		if [ "$KEYWORD_SCAN_STATS" = "true" ]
+		then
+			echo $(( ($(date +%s%N) - started) / 1000 )) >> "$0.batches"
+		fi
+		flock "$0" cat "$0.$$"
+		rm -f "$0.$$"
+		[ "$status" -le 1 ]' "$scratch/out" "${match[@]}" -f "$keywords" -- < "$files") |
+	LC_ALL=C sed 's/\x01/\x01\x01/g; s/\x00/\x01/' |
+	LC_ALL=C awk -v icase="$icase" -v word="$word" -v objects="$objects" -v links="$links/" \
+		-f .github/keyword-hits.awk .github/keywords.txt -
+status=("${PIPESTATUS[@]}")
+scanned=$(date +%s%N)
+if [ "${status[0]}" -ne 0 ] || [ "${status[2]}" -gt 1 ]
+then
+	echo "Keyword check error: scan failed (xargs status ${status[0]}, awk status ${status[2]})" >&2
+	exit 2
+fi
+# Record a pass only for a checkout with nothing outside HEAD, so the
+# marker describes exactly the content of that commit.
+if [ "${status[2]}" -eq 1 ] && [ -n "$KEYWORD_SCAN_CACHE" ] && [ "$objects" -eq 0 ] &&
+	[ -z "$(git status --porcelain)" ]
+then
+	mkdir -p "$KEYWORD_SCAN_CACHE/$key" &&
+		touch "$KEYWORD_SCAN_CACHE/$key/$(git rev-parse HEAD)"
+fi
+if [ "$KEYWORD_SCAN_STATS" = "true" ]
+then
+	# grep runs on batches of up to 256 files, so latency is measured per
+	# batch (nearest-rank percentiles); single files are not timed.
+	read -r batches batch_p50_ms batch_p99_ms < <(
+		sort -n "$scratch/out.batches" 2> /dev/null |
+			awk '
+				function rank(p,    i) {
+					i = int(NR * p)
+					return t[i < NR * p ? i + 1 : (i ? i : 1)] / 1000
+				}
+				{ t[NR] = $1 }
+				END { printf "%d %.3f %.3f\n", NR, NR ? rank(0.50) : 0, NR ? rank(0.99) : 0 }')
+	# Counts cover every file handed to grep, including binary files that
+	# -I then skips. Sizes come from the inodes, so nothing is read again.
+	(cd "$root" && xargs -0 -r stat -c %s -- < "$files") |
+		awk -v mode="$mode" -v skipped="$skipped" \
+			-v select_ms=$(( (selected - started) / 1000000 )) \
+			-v scan_ms=$(( (scanned - selected) / 1000000 )) \
+			-v batches="$batches" -v batch_p50_ms="$batch_p50_ms" -v batch_p99_ms="$batch_p99_ms" '
+			{ files++; bytes += $1 }
+			END {
+				printf "{\"mode\": \"%s\", \"select_ms\": %d, \"scan_ms\": %d, \"selected_files\": %d, \"selected_bytes\": %d, \"skipped\": %d, \"batches\": %d, \"batch_p50_ms\": %s, \"batch_p99_ms\": %s}\n",
+					mode, select_ms, scan_ms, files, bytes, skipped, batches, batch_p50_ms, batch_p99_ms
+			}' >&2
+fi
+# keyword-hits.awk exits 0 when it reported hits, like grep.
+if [ "${status[2]}" -eq 0 ]
+then
+	echo "Keyword Check Failed. Pl. check and fix it"
+else
+	echo "Keyword check Passed."
+fi
@@ -0,0 +1,248 @@
+# Turns `grep -H -n -Z` output into one JSON object per keyword hit.
+#
+# Inputs, in order:
+#   1. the keyword list, one keyword per line
+#   2. the grep hits, with every \001 doubled and the NUL after each file
+#      name then replaced by a single \001, so the separator is unambiguous
+#
+# A file name containing a newline arrives split over several records;
+# records without a separator are joined to the one that follows them.
+#
+# Hits are resolved leftmost-longest: scanning each line left to right,
+# the earliest keyword occurrence wins, ties go to the longest keyword,
+# and scanning resumes after it. A keyword that starts with a shorter
+# keyword is reported once, as itself, and hits never overlap.
+#
+# Set -v icase=1 to match case-insensitively and -v word=1 to accept
+# only occurrences that are not part of a longer word, matching the
+# `grep -i` and `-w` options used to select the lines.
+#
+# Set -v objects=1 when grepping the blobs written out from the object
+# database, whose paths carry the blob OID as a last component; it is
+# stripped from the reported file name. Otherwise the blob OID is that of
+# the file's current content, from `git hash-object`.
+#
+# Set -v links=<dir>/ to the directory holding the link text of scanned
+# symlinks; hits in those copies are reported under the link's own path.
+#
+# Run it with LC_ALL=C, like the grep it follows: columns are counted in
+# bytes and -i folds ASCII letters only.
+#
+# Like grep, exits 0 if any line was reported and 1 otherwise.
+
+# Replaces every occurrence of the single character from in s by to.
+function replace(s, from, to,    parts, n, i, out) {
+	n = split(s, parts, from)
+	out = parts[1]
+	for (i = 2; i <= n; i++)
+		out = out to parts[i]
+	return out
+}
+
+function code(c) {
+	return (c in byte) ? byte[c] : 0
+}
+
+# Keeps well-formed UTF-8 sequences in s and writes every other byte of
+# 0x80 and above as \u00XX, that is, reads it as Latin-1.
+function utf8(s,    out, n, i, j, b, need, lo, hi, ok) {
+	n = length(s)
+	for (i = 1; i <= n; i++) {
+		b = code(substr(s, i, 1))
+		if (b < 128) {
+			out = out substr(s, i, 1)
+			continue
+		}
+		need = 0
+		lo = 128
+		hi = 191
+		if (b >= 194 && b <= 223)
+			need = 1
+		else if (b >= 224 && b <= 239) {
+			need = 2
+			if (b == 224)
+				lo = 160
+			if (b == 237)
+				hi = 159
+		} else if (b >= 240 && b <= 244) {
+			need = 3
+			if (b == 240)
+				lo = 144
+			if (b == 244)
+				hi = 143
+		}
+		ok = need > 0
+		for (j = 1; ok && j <= need; j++) {
+			b = code(substr(s, i + j, 1))
+			ok = j == 1 ? b >= lo && b <= hi : b >= 128 && b <= 191
+		}
+		if (ok) {
+			out = out substr(s, i, need + 1)
+			i += need
+		} else
+			out = out sprintf("\\u%04x", code(substr(s, i, 1)))
+	}
+	return out
+}
+
+function json(s,    c) {
+	s = replace(s, "\\", "\\\\")
+	s = replace(s, "\"", "\\\"")
+	for (c = 1; c < 32; c++)
+		if (index(s, control[c]))
+			s = replace(s, control[c], sprintf("\\u%04x", c))
+	if (s ~ high)
+		s = utf8(s)
+	return "\"" s "\""
+}
+
+# Returns the position of the file-name separator in s: a \001 that is
+# not half of a doubled one. Returns 0 if there is none.
+function separator(s,    at, p) {
+	at = 0
+	while ((p = index(substr(s, at + 1), "\001")) > 0) {
+		at += p
+		if (substr(s, at + 1, 1) != "\001")
+			return at
+		at++
+	}
+	return 0
+}
+
+function unescape(s) {
+	gsub("\001\001", "\001", s)
+	return s
+}
+
+function blob_oid(file, options,    cmd) {
+	if (!(file in oid)) {
+		cmd = "git hash-object " options " -- '" replace(file, "'", "'\\''") "'"
+		oid[file] = ""
+		cmd | getline oid[file]
+		close(cmd)
+	}
+	return oid[file]
+}
+
+function isword(c) {
+	return c ~ /[A-Za-z0-9_]/
+}
+
+# Returns s as a regular expression matching itself literally.
+function literal(s,    out, i, c) {
+	for (i = 1; i <= length(s); i++) {
+		c = substr(s, i, 1)
+		if (c ~ /[A-Za-z0-9]/)
+			out = out c
+		else if (c == "\\" || c == "^")
+			out = out "\\" c
+		else
+			out = out "[" c "]"
+	}
+	return out
+}
+
+function accept(at, len) {
+	return !word || ((at == 1 || !isword(substr(text, at - 1, 1))) &&
+	    !isword(substr(text, at + len, 1)))
+}
+
+# Collects in occ[k, 1..nocc[k]] the leftmost, non-overlapping
+# occurrences of keyword k in text, in one split over the line.
+function locate(k,    parts, n, i, at) {
+	n = split(text, parts, pattern[k])
+	at = 1
+	for (i = 1; i < n; i++) {
+		at += length(parts[i])
+		occ[k, i] = at
+		at += length(keys[k])
+	}
+	nocc[k] = n > 0 ? n - 1 : 0
+	next_occ[k] = 1
+}
+
+# Returns the position of the first acceptable occurrence of keyword k at
+# or after from, or 0 if there is none. Occurrences that split skipped
+# overlap an earlier one, so they start inside that one's span and are
+# checked there; nothing before from is looked at again.
+function find(k, from,    at, len, q) {
+	len = length(keys[k])
+	for (; next_occ[k] <= nocc[k]; next_occ[k]++) {
+		at = occ[k, next_occ[k]]
+		for (q = at < from ? from : at; q < at + len; q++)
+			if ((q == at || substr(text, q, len) == keys[k]) && accept(q, len))
+				return q
+	}
+	return 0
+}
+
+BEGIN {
+	for (c = 1; c < 32; c++)
+		control[c] = sprintf("%c", c)
+	for (c = 128; c < 256; c++)
+		byte[sprintf("%c", c)] = c
+	high = "[\200-\377]"
+}
+
+FILENAME == ARGV[1] {
+	if ($0 != "") {
+		keywords[++nkeywords] = $0
+		keys[nkeywords] = icase ? tolower($0) : $0
+		pattern[nkeywords] = literal(keys[nkeywords])
+	}
+	next
+}
+
+{
+	record = partial $0
+	sep = separator(record)
+	if (!sep) {
+		partial = record "\n"
+		next
+	}
+	partial = ""
+	file = unescape(substr(record, 1, sep - 1))
+	text = unescape(substr(record, sep + 1))
+	colon = index(text, ":")
+	line = substr(text, 1, colon - 1)
+	text = substr(text, colon + 1)
+	if (objects) {
+		blob = file
+		sub(/.*\//, "", blob)
+		sub(/\/[^\/]*$/, "", file)
+	} else if (links != "" && index(file, links) == 1) {
+		blob = blob_oid(file, "--no-filters")
+		file = substr(file, length(links) + 1)
+	} else
+		blob = blob_oid(file, "")
+	lines++
+	if (icase)
+		text = tolower(text)
+	# Each keyword's next position is kept in found[] and only searched
+	# again once a hit has moved past it.
+	delete occ
+	for (k = 1; k <= nkeywords; k++) {
+		locate(k)
+		found[k] = find(k, 1)
+	}
+	for (from = 1; ; from = best + length(keys[bestk])) {
+		best = 0
+		for (k = 1; k <= nkeywords; k++) {
+			if (found[k] && found[k] < from)
+				found[k] = find(k, from)
+			if (found[k] && (!best || found[k] < best ||
+			    (found[k] == best && length(keys[k]) > length(keys[bestk])))) {
+				best = found[k]
+				bestk = k
+			}
+		}
+		if (!best)
+			break
+		printf "{\"file\": %s, \"line\": %d, \"column\": %d, \"keyword\": %s, \"blob_oid\": %s}\n",
+			json(file), line, best, json(keywords[bestk]), json(blob)
+	}
+}
+
+END {
+	exit !lines
+}